@@ -8,6 +8,7 @@ Usage:
     python run_all_tests.py              # Run all tests
     python run_all_tests.py --sim-only   # Run only simulation tests
     python run_all_tests.py --hw-only    # Run only hardware tests
+    python run_all_tests.py --size       # Also run flash/RAM footprint report
 """
 
 import sys
@@ -55,12 +56,31 @@ def run_hardware_tests():
     return result.returncode == 0
 
 
+def run_size_report():
+    """Run flash/RAM footprint report"""
+    print("\n" + "="*60)
+    print("Running Size Report")
+    print("="*60)
+    
+    size_dir = Path(__file__).parent / "tests" / "size"
+    size_runner = size_dir / "run_size_report.py"
+    
+    if not size_runner.exists():
+        print(f"Size report not found: {size_runner}")
+        return False
+    
+    result = subprocess.run([sys.executable, str(size_runner)], cwd=str(size_dir))
+    return result.returncode == 0
+
+
 def main():
     parser = argparse.ArgumentParser(description="Run all tests for papilio_template")
     parser.add_argument("--sim-only", action="store_true", 
                        help="Run only simulation tests")
     parser.add_argument("--hw-only", action="store_true",
                        help="Run only hardware tests")
+    parser.add_argument("--size", action="store_true",
+                       help="Also run flash/RAM footprint report")
     args = parser.parse_args()
     
     print("="*60)
@@ -69,6 +89,7 @@ def main():
     
     sim_pass = True
     hw_pass = True
+    size_pass = True
     
     # Run simulation tests
     if not args.hw_only:
@@ -78,6 +99,10 @@ def main():
     if not args.sim_only:
         hw_pass = run_hardware_tests()
     
+    # Run size report
+    if args.size:
+        size_pass = run_size_report()
+    
     # Summary
     print("\n" + "="*60)
     print("Overall Test Summary")
@@ -91,7 +116,11 @@ def main():
         status = "[PASS]" if hw_pass else "[FAIL]"
         print(f"{status}: Hardware Tests")
     
-    overall_pass = sim_pass and hw_pass
+    if args.size:
+        status = "[PASS]" if size_pass else "[FAIL]"
+        print(f"{status}: Size Report")
+    
+    overall_pass = sim_pass and hw_pass and size_pass
     print(f"\nOverall: {'PASS' if overall_pass else 'FAIL'}")
     
     return 0 if overall_pass else 1
@@ -68,20 +68,155 @@ void PapilioTemplate::reset() {
     delay(10);  // Allow device to stabilize
 }
 
+#ifdef PAPILIO_TEMPLATE_TRACE
+
+// Trace buffer
+
+// Static storage is zero-initialized, so every slot starts out empty (seq 0)
+PapilioTemplate::TraceSlot PapilioTemplate::_trace[PapilioTemplate::TRACE_DEPTH];
+std::atomic<uint32_t> PapilioTemplate::_traceHead(0);
+std::atomic<uint32_t> PapilioTemplate::_traceTail(0);
+
+PapilioTemplate::TraceSnapshot PapilioTemplate::snapshotTrace() {
+    uint32_t tail = _traceTail.load(std::memory_order_acquire);
+    uint32_t head = _traceHead.load(std::memory_order_acquire);
+
+    uint32_t count = head - tail;
+    if (count > TRACE_DEPTH) {
+        count = TRACE_DEPTH;
+    }
+
+    TraceSnapshot snapshot = { head - count, count };
+    return snapshot;
+}
+
+bool PapilioTemplate::getTraceEntry(const TraceSnapshot& snapshot, size_t index,
+                                    TraceEntry& entry) {
+    if (index >= snapshot.count) {
+        return false;
+    }
+
+    uint32_t pos = snapshot.first + index;
+    const TraceSlot& slot = _trace[pos & (TRACE_DEPTH - 1)];
+
+    // Slot must hold this position and be complete
+    uint32_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq != pos + 1) {
+        return false;
+    }
+
+    uint32_t timestampLo = slot.timestampLo.load(std::memory_order_relaxed);
+    uint32_t timestampHi = slot.timestampHi.load(std::memory_order_relaxed);
+    uint32_t duration = slot.duration.load(std::memory_order_relaxed);
+    uint32_t value = slot.value.load(std::memory_order_relaxed);
+    uint32_t address = slot.address.load(std::memory_order_relaxed);
+    uint32_t info = slot.info.load(std::memory_order_relaxed);
+
+    // Reject the copy if a writer claimed the slot meanwhile
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seq) {
+        return false;
+    }
+
+    entry.timestamp = ((uint64_t)timestampHi << 32) | timestampLo;
+    entry.duration = duration;
+    entry.value = value;
+    entry.baseAddress = address >> 16;
+    entry.offset = address & 0xFFFF;
+    entry.direction = info >> 8;
+    entry.width = info & 0xFF;
+    return true;
+}
+
+size_t PapilioTemplate::getTraceCount() {
+    return snapshotTrace().count;
+}
+
+bool PapilioTemplate::getTraceEntry(size_t index, TraceEntry& entry) {
+    return getTraceEntry(snapshotTrace(), index, entry);
+}
+
+void PapilioTemplate::clearTrace() {
+    // Positions keep increasing so old slots can never match a new position
+    _traceTail.store(_traceHead.load(std::memory_order_acquire),
+                     std::memory_order_release);
+}
+
+void PapilioTemplate::traceRecord(int64_t start, uint16_t offset, uint8_t direction,
+                                  uint8_t width, uint32_t value) {
+    uint32_t duration = (uint32_t)(esp_timer_get_time() - start);
+
+    // Claim a position; concurrent writers each get their own
+    uint32_t pos = _traceHead.fetch_add(1, std::memory_order_relaxed);
+    TraceSlot& slot = _trace[pos & (TRACE_DEPTH - 1)];
+
+    // Mark the slot busy before touching its fields
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestampLo.store((uint32_t)start, std::memory_order_relaxed);
+    slot.timestampHi.store((uint32_t)((uint64_t)start >> 32), std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.address.store(((uint32_t)_baseAddress << 16) | offset, std::memory_order_relaxed);
+    slot.info.store(((uint32_t)direction << 8) | width, std::memory_order_relaxed);
+
+    // Publish
+    slot.seq.store(pos + 1, std::memory_order_release);
+}
+
+#endif // PAPILIO_TEMPLATE_TRACE
+
 // Helper methods for register access
 
 void PapilioTemplate::writeReg8(uint16_t offset, uint8_t value) {
+#ifdef PAPILIO_TEMPLATE_TRACE
+    int64_t start = esp_timer_get_time();
+#endif
+
     wishboneWrite8(_baseAddress + offset, value);
+
+#ifdef PAPILIO_TEMPLATE_TRACE
+    traceRecord(start, offset, TRACE_WRITE, 8, value);
+#endif
 }
 
 uint8_t PapilioTemplate::readReg8(uint16_t offset) {
-    return wishboneRead8(_baseAddress + offset);
+#ifdef PAPILIO_TEMPLATE_TRACE
+    int64_t start = esp_timer_get_time();
+#endif
+
+    uint8_t value = wishboneRead8(_baseAddress + offset);
+
+#ifdef PAPILIO_TEMPLATE_TRACE
+    traceRecord(start, offset, TRACE_READ, 8, value);
+#endif
+
+    return value;
 }
 
 void PapilioTemplate::writeReg32(uint16_t offset, uint32_t value) {
+#ifdef PAPILIO_TEMPLATE_TRACE
+    int64_t start = esp_timer_get_time();
+#endif
+
     wishboneWrite32(_baseAddress + offset, value);
+
+#ifdef PAPILIO_TEMPLATE_TRACE
+    traceRecord(start, offset, TRACE_WRITE, 32, value);
+#endif
 }
 
 uint32_t PapilioTemplate::readReg32(uint16_t offset) {
-    return wishboneRead32(_baseAddress + offset);
+#ifdef PAPILIO_TEMPLATE_TRACE
+    int64_t start = esp_timer_get_time();
+#endif
+
+    uint32_t value = wishboneRead32(_baseAddress + offset);
+
+#ifdef PAPILIO_TEMPLATE_TRACE
+    traceRecord(start, offset, TRACE_READ, 32, value);
+#endif
+
+    return value;
 }
@@ -4,6 +4,16 @@
 #include <Arduino.h>
 #include <WishboneSPI.h>
 
+#ifdef PAPILIO_TEMPLATE_TRACE
+#include <atomic>
+#include <esp_timer.h>
+
+// Number of entries kept in the trace ring buffer (must be a power of two)
+#ifndef PAPILIO_TEMPLATE_TRACE_DEPTH
+#define PAPILIO_TEMPLATE_TRACE_DEPTH 256
+#endif
+#endif
+
 /**
  * @brief Main class for PapilioTemplate library
  * 
@@ -14,6 +24,11 @@
  * 
  * When ENABLE_PAPILIO_OS is defined, a CLI interface is also available
  * via the PapilioTemplateOS plugin.
+ * 
+ * When PAPILIO_TEMPLATE_TRACE is defined, every register access is recorded
+ * in a fixed-size, lock-free ring buffer of PAPILIO_TEMPLATE_TRACE_DEPTH
+ * entries. The buffer is static and shared by all instances; the oldest
+ * entries are overwritten when it is full.
  */
 class PapilioTemplate {
 public:
@@ -84,6 +99,86 @@ public:
      */
     uint16_t getBaseAddress() const { return _baseAddress; }
 
+#ifdef PAPILIO_TEMPLATE_TRACE
+    /**
+     * @brief Direction of a traced register access
+     */
+    enum TraceDirection : uint8_t {
+        TRACE_READ  = 0,
+        TRACE_WRITE = 1
+    };
+
+    /**
+     * @brief One recorded register access
+     */
+    struct TraceEntry {
+        uint64_t timestamp;     // esp_timer_get_time() when the access started
+        uint32_t duration;      // Access time in microseconds
+        uint32_t value;         // Value read or written
+        uint16_t baseAddress;   // Base address of the device accessed
+        uint16_t offset;        // Register offset from base address
+        uint8_t direction;      // TRACE_READ or TRACE_WRITE
+        uint8_t width;          // Access width in bits (8 or 32)
+    };
+
+    /**
+     * @brief Fixed window of trace positions to read from
+     * 
+     * Take a snapshot once and read every entry through it, so accesses
+     * recorded while reading do not shift the indices.
+     */
+    struct TraceSnapshot {
+        uint32_t first;   // Position of the oldest entry
+        uint32_t count;   // Number of entries in the window
+    };
+
+    static constexpr size_t TRACE_DEPTH = PAPILIO_TEMPLATE_TRACE_DEPTH;
+
+    /**
+     * @brief Capture the current window of the trace buffer
+     * 
+     * @return TraceSnapshot Window holding at most TRACE_DEPTH entries
+     */
+    static TraceSnapshot snapshotTrace();
+
+    /**
+     * @brief Copy a trace entry from a snapshot
+     * 
+     * Safe to call while other tasks access registers. Entries that are
+     * being written or were overwritten since the snapshot are rejected.
+     * 
+     * @param snapshot Window returned by snapshotTrace()
+     * @param index Entry index, 0 is the oldest entry
+     * @param entry Destination for the entry
+     * @return true if the entry was copied, false if invalid or overwritten
+     */
+    static bool getTraceEntry(const TraceSnapshot& snapshot, size_t index, TraceEntry& entry);
+
+    /**
+     * @brief Get the number of entries currently held in the trace buffer
+     * 
+     * @return size_t Entry count (at most TRACE_DEPTH)
+     */
+    static size_t getTraceCount();
+
+    /**
+     * @brief Copy a trace entry from the current window
+     * 
+     * Convenience overload for single lookups; use a snapshot when reading
+     * several entries.
+     * 
+     * @param index Entry index, 0 is the oldest entry
+     * @param entry Destination for the entry
+     * @return true if the entry was copied, false if invalid or overwritten
+     */
+    static bool getTraceEntry(size_t index, TraceEntry& entry);
+
+    /**
+     * @brief Discard all recorded trace entries
+     */
+    static void clearTrace();
+#endif
+
 private:
     // TODO: Define your register addresses relative to base address
     static constexpr uint16_t REG_CONTROL = 0x00;  // Control register
@@ -100,6 +195,31 @@ private:
 
     uint16_t _baseAddress;  // Wishbone base address
 
+#ifdef PAPILIO_TEMPLATE_TRACE
+    static_assert((TRACE_DEPTH & (TRACE_DEPTH - 1)) == 0,
+                  "PAPILIO_TEMPLATE_TRACE_DEPTH must be a power of two");
+
+    // Ring buffer slot. seq is the slot's position + 1 once the fields are
+    // complete and 0 while a writer owns it (seqlock). Fields are relaxed
+    // atomics so concurrent copies are well-defined.
+    struct TraceSlot {
+        std::atomic<uint32_t> seq;
+        std::atomic<uint32_t> timestampLo;
+        std::atomic<uint32_t> timestampHi;
+        std::atomic<uint32_t> duration;
+        std::atomic<uint32_t> value;
+        std::atomic<uint32_t> address;  // baseAddress << 16 | offset
+        std::atomic<uint32_t> info;     // direction << 8 | width
+    };
+
+    static TraceSlot _trace[TRACE_DEPTH];       // Shared trace ring buffer
+    static std::atomic<uint32_t> _traceHead;    // Next position to write
+    static std::atomic<uint32_t> _traceTail;    // Head at last clearTrace()
+
+    void traceRecord(int64_t start, uint16_t offset, uint8_t direction,
+                     uint8_t width, uint32_t value);
+#endif
+
     // Helper methods for register access
     void writeReg8(uint16_t offset, uint8_t value);
     uint8_t readReg8(uint16_t offset);
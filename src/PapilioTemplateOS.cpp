@@ -5,6 +5,16 @@
 // Singleton instance for static callbacks
 PapilioTemplateOS* PapilioTemplateOS::_instance = nullptr;
 
+// Fixed output buffer for number formatting (up to 20 decimal digits + NUL).
+// The CLI runs from a single task, so one shared buffer is sufficient.
+static char s_numBuf[21];
+
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
+// Fixed buffers for tutorial input and command tokenizing
+static char s_inputBuf[32];
+static char s_cmdBuf[64];
+#endif
+
 PapilioTemplateOS::PapilioTemplateOS(PapilioTemplate* device)
     : _device(device) {
     _instance = this;
@@ -17,8 +27,10 @@ void PapilioTemplateOS::setDevice(PapilioTemplate* device) {
 
 void PapilioTemplateOS::registerCommands() {
     // Register all commands with the "template" module prefix
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
     PapilioOS.registerCommand("template", "tutorial", handleTutorial, 
                               "Interactive step-by-step tutorial");
+#endif
     PapilioOS.registerCommand("template", "help", handleHelp, 
                               "Show all available commands");
     PapilioOS.registerCommand("template", "status", handleStatus, 
@@ -33,24 +45,82 @@ void PapilioTemplateOS::registerCommands() {
                               "Read data from device");
     PapilioOS.registerCommand("template", "reset", handleReset, 
                               "Reset the device");
+#ifdef PAPILIO_TEMPLATE_TRACE
+    PapilioOS.registerCommand("template", "trace", handleTrace, 
+                              "Register trace: template trace <dump|clear>");
+#endif
+}
+
+// Output Helpers
+
+void PapilioTemplateOS::printHex(uint32_t value, uint8_t digits) {
+    static const char hexDigits[] = "0123456789ABCDEF";
+
+    if (digits > 8) {
+        digits = 8;
+    }
+
+    s_numBuf[0] = '0';
+    s_numBuf[1] = 'x';
+    for (uint8_t i = 0; i < digits; i++) {
+        s_numBuf[1 + digits - i] = hexDigits[value & 0x0F];
+        value >>= 4;
+    }
+    s_numBuf[2 + digits] = '\0';
+
+    Serial.print(s_numBuf);
 }
 
+void PapilioTemplateOS::printDec(uint32_t value) {
+    char* p = &s_numBuf[sizeof(s_numBuf) - 1];
+    *p = '\0';
+    do {
+        *--p = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    Serial.print(p);
+}
+
+#ifdef PAPILIO_TEMPLATE_TRACE
+void PapilioTemplateOS::printDec64(uint64_t value) {
+    char* p = &s_numBuf[sizeof(s_numBuf) - 1];
+    *p = '\0';
+    do {
+        *--p = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    Serial.print(p);
+}
+#endif
+
 // Command Handlers
 
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
 void PapilioTemplateOS::handleTutorial(int argc, char** argv) {
     runTutorial();
 }
+#endif
 
 void PapilioTemplateOS::handleHelp(int argc, char** argv) {
     Serial.println("\nPapilioTemplate Commands:");
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
     Serial.println("  template tutorial       - Interactive step-by-step tutorial");
+#endif
     Serial.println("  template status         - Display device status");
     Serial.println("  template enable         - Enable the device");
     Serial.println("  template disable        - Disable the device");
     Serial.println("  template write <value>  - Write data to device (hex or decimal)");
     Serial.println("  template read           - Read data from device");
     Serial.println("  template reset          - Reset the device");
+#ifdef PAPILIO_TEMPLATE_TRACE
+    Serial.println("  template trace dump     - Export register trace as Chrome/Perfetto JSON");
+    Serial.println("  template trace clear    - Discard recorded register trace");
+#endif
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
     Serial.println("\nFor detailed guidance, run: template tutorial");
+#endif
 }
 
 void PapilioTemplateOS::handleStatus(int argc, char** argv) {
@@ -62,10 +132,16 @@ void PapilioTemplateOS::handleStatus(int argc, char** argv) {
     uint8_t status = _instance->_device->getStatus();
     
     Serial.println("\nDevice Status:");
-    Serial.printf("  Status Register: 0x%02X\n", status);
-    Serial.printf("  Ready: %s\n", (status & 0x01) ? "Yes" : "No");
-    Serial.printf("  Error: %s\n", (status & 0x02) ? "Yes" : "No");
-    Serial.printf("  Base Address: 0x%04X\n", _instance->_device->getBaseAddress());
+    Serial.print("  Status Register: ");
+    printHex(status, 2);
+    Serial.println();
+    Serial.print("  Ready: ");
+    Serial.println((status & 0x01) ? "Yes" : "No");
+    Serial.print("  Error: ");
+    Serial.println((status & 0x02) ? "Yes" : "No");
+    Serial.print("  Base Address: ");
+    printHex(_instance->_device->getBaseAddress(), 4);
+    Serial.println();
 }
 
 void PapilioTemplateOS::handleEnable(int argc, char** argv) {
@@ -109,7 +185,9 @@ void PapilioTemplateOS::handleWrite(int argc, char** argv) {
     }
 
     _instance->_device->writeData(value);
-    Serial.printf("Wrote 0x%08X to device\n", value);
+    Serial.print("Wrote ");
+    printHex(value, 8);
+    Serial.println(" to device");
 }
 
 void PapilioTemplateOS::handleRead(int argc, char** argv) {
@@ -119,7 +197,11 @@ void PapilioTemplateOS::handleRead(int argc, char** argv) {
     }
 
     uint32_t value = _instance->_device->readData();
-    Serial.printf("Read: 0x%08X (%u)\n", value, value);
+    Serial.print("Read: ");
+    printHex(value, 8);
+    Serial.print(" (");
+    printDec(value);
+    Serial.println(")");
 }
 
 void PapilioTemplateOS::handleReset(int argc, char** argv) {
@@ -132,8 +214,70 @@ void PapilioTemplateOS::handleReset(int argc, char** argv) {
     Serial.println("Device reset");
 }
 
+#ifdef PAPILIO_TEMPLATE_TRACE
+void PapilioTemplateOS::handleTrace(int argc, char** argv) {
+    // The trace buffer is shared by all devices, so no device is required
+    if (argc >= 2 && strcmp(argv[1], "dump") == 0) {
+        dumpTrace();
+    } else if (argc >= 2 && strcmp(argv[1], "clear") == 0) {
+        PapilioTemplate::clearTrace();
+        Serial.println("Trace cleared");
+    } else {
+        Serial.println("Usage: template trace <dump|clear>");
+        Serial.println("  dump:  export trace as Chrome trace / Perfetto JSON");
+        Serial.println("  clear: discard recorded trace");
+    }
+}
+
+void PapilioTemplateOS::dumpTrace() {
+    // Streams Chrome trace event format ("X" complete events, timestamps in
+    // microseconds). Save the output as a .json file and open it in
+    // chrome://tracing or ui.perfetto.dev. The device base address is used as
+    // the thread id so multiple devices appear on separate tracks.
+    //
+    // The window is fixed up front; entries overwritten while the (slow)
+    // serial output is in progress are skipped rather than re-read.
+    PapilioTemplate::TraceSnapshot snapshot = PapilioTemplate::snapshotTrace();
+    PapilioTemplate::TraceEntry entry;
+    bool first = true;
+
+    Serial.print("{\"traceEvents\":[");
+
+    for (size_t i = 0; i < snapshot.count; i++) {
+        if (!PapilioTemplate::getTraceEntry(snapshot, i, entry)) {
+            continue;
+        }
+
+        Serial.println(first ? "" : ",");
+        first = false;
+
+        Serial.print("{\"name\":\"");
+        Serial.print(entry.direction == PapilioTemplate::TRACE_WRITE ? "write" : "read");
+        printDec(entry.width);
+        Serial.print(" +");
+        printHex(entry.offset, 2);
+        Serial.print("\",\"cat\":\"wishbone\",\"ph\":\"X\",\"ts\":");
+        printDec64(entry.timestamp);
+        Serial.print(",\"dur\":");
+        printDec(entry.duration);
+        Serial.print(",\"pid\":1,\"tid\":");
+        printDec(entry.baseAddress);
+        Serial.print(",\"args\":{\"offset\":\"");
+        printHex(entry.offset, 2);
+        Serial.print("\",\"value\":\"");
+        printHex(entry.value, entry.width / 4);
+        Serial.print("\"}}");
+    }
+
+    Serial.println();
+    Serial.println("],\"displayTimeUnit\":\"ns\"}");
+}
+#endif
+
 // Tutorial Implementation
 
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
+
 void PapilioTemplateOS::runTutorial() {
     Serial.println("\n========================================");
     Serial.println("   PapilioTemplate Interactive Tutorial");
@@ -187,8 +331,12 @@ void PapilioTemplateOS::runTutorial() {
 }
 
 bool PapilioTemplateOS::tutorialStep(int stepNum, const char* description, const char* command) {
-    Serial.printf("\nStep %d: %s\n", stepNum, description);
-    Serial.printf("Try the command: %s\n", command);
+    Serial.print("\nStep ");
+    printDec(stepNum);
+    Serial.print(": ");
+    Serial.println(description);
+    Serial.print("Try the command: ");
+    Serial.println(command);
     Serial.print("\nPress Enter when ready (or type 'exit' to quit): ");
 
     // Wait for user input
@@ -196,31 +344,30 @@ bool PapilioTemplateOS::tutorialStep(int stepNum, const char* description, const
         delay(10);
     }
 
-    // Read the line
-    String input = Serial.readStringUntil('\n');
-    input.trim();
+    // Read the line into a fixed buffer
+    readLine(s_inputBuf, sizeof(s_inputBuf));
 
     Serial.println();  // New line after input
 
     // Check for exit
-    if (input.equalsIgnoreCase("exit") || input.equalsIgnoreCase("quit")) {
+    if (strcasecmp(s_inputBuf, "exit") == 0 || strcasecmp(s_inputBuf, "quit") == 0) {
         Serial.println("Tutorial exited.");
         return false;
     }
 
     // Show the command being executed
-    Serial.printf("> %s\n", command);
+    Serial.print("> ");
+    Serial.println(command);
 
     // Parse and execute the command
     // Note: This is a simplified version - real implementation would
     // use the actual command parser from PapilioOS
-    char cmdCopy[128];
-    strncpy(cmdCopy, command, sizeof(cmdCopy) - 1);
-    cmdCopy[sizeof(cmdCopy) - 1] = '\0';
+    strncpy(s_cmdBuf, command, sizeof(s_cmdBuf) - 1);
+    s_cmdBuf[sizeof(s_cmdBuf) - 1] = '\0';
 
     char* argv[10];
     int argc = 0;
-    char* token = strtok(cmdCopy, " ");
+    char* token = strtok(s_cmdBuf, " ");
     while (token && argc < 10) {
         argv[argc++] = token;
         token = strtok(nullptr, " ");
@@ -247,4 +394,34 @@ bool PapilioTemplateOS::tutorialStep(int stepNum, const char* description, const
     return true;
 }
 
+size_t PapilioTemplateOS::readLine(char* buffer, size_t size) {
+    // readBytesUntil() consumes the terminator and honours the Stream timeout
+    size_t len = Serial.readBytesUntil('\n', buffer, size - 1);
+
+    // Discard the rest of an over-long line, including bytes still in
+    // flight; find() waits up to the Stream timeout for the terminator
+    if (len == size - 1) {
+        Serial.find("\n");
+    }
+
+    // Trim trailing and leading whitespace (including '\r')
+    while (len > 0 && isspace((unsigned char)buffer[len - 1])) {
+        len--;
+    }
+    buffer[len] = '\0';
+
+    size_t start = 0;
+    while (start < len && isspace((unsigned char)buffer[start])) {
+        start++;
+    }
+    if (start > 0) {
+        memmove(buffer, buffer + start, len - start + 1);
+        len -= start;
+    }
+
+    return len;
+}
+
+#endif // PAPILIO_TEMPLATE_NO_TUTORIAL
+
 #endif // ENABLE_PAPILIO_OS
@@ -14,8 +14,15 @@
  * This plugin automatically registers itself with papilio_os when ENABLE_PAPILIO_OS
  * is defined. No explicit registration is needed in user code.
  * 
+ * The command path is allocation-free: output is formatted into fixed static
+ * buffers and tutorial input is read without Arduino String, so the plugin
+ * causes no heap churn on long-running systems.
+ * 
+ * Define PAPILIO_TEMPLATE_NO_TUTORIAL to compile out the interactive tutorial
+ * and its text, saving flash in production builds.
+ * 
  * Available commands:
- * - template tutorial - Interactive step-by-step tutorial
+ * - template tutorial - Interactive step-by-step tutorial (unless compiled out)
  * - template help     - Show all available commands
  * - template status   - Display device status
  * - template enable   - Enable the device
@@ -23,6 +30,7 @@
  * - template write    - Write data to device
  * - template read     - Read data from device
  * - template reset    - Reset the device
+ * - template trace    - Dump or clear the register trace (PAPILIO_TEMPLATE_TRACE)
  */
 class PapilioTemplateOS {
 public:
@@ -52,7 +60,9 @@ private:
     void registerCommands();
 
     // Command handlers
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
     static void handleTutorial(int argc, char** argv);
+#endif
     static void handleHelp(int argc, char** argv);
     static void handleStatus(int argc, char** argv);
     static void handleEnable(int argc, char** argv);
@@ -60,10 +70,24 @@ private:
     static void handleWrite(int argc, char** argv);
     static void handleRead(int argc, char** argv);
     static void handleReset(int argc, char** argv);
+#ifdef PAPILIO_TEMPLATE_TRACE
+    static void handleTrace(int argc, char** argv);
+    static void dumpTrace();
+#endif
+
+    // Allocation-free output helpers (format into a static buffer)
+    static void printHex(uint32_t value, uint8_t digits);
+    static void printDec(uint32_t value);
+#ifdef PAPILIO_TEMPLATE_TRACE
+    static void printDec64(uint64_t value);
+#endif
 
+#ifndef PAPILIO_TEMPLATE_NO_TUTORIAL
     // Tutorial implementation
     static void runTutorial();
     static bool tutorialStep(int stepNum, const char* description, const char* command);
+    static size_t readLine(char* buffer, size_t size);
+#endif
 
     // Singleton instance for static callbacks
     static PapilioTemplateOS* _instance;
@@ -121,12 +121,55 @@ void test_base_address(void) {
     // TODO: Test that device operates correctly at different base address
 }
 
+#ifdef PAPILIO_TEMPLATE_TRACE
+// Test 8: Register access trace
+void test_trace(void) {
+    PapilioTemplate::TraceEntry entry;
+
+    PapilioTemplate::clearTrace();
+    TEST_ASSERT_EQUAL_UINT32(0, PapilioTemplate::getTraceCount());
+
+    device.writeData(0xCAFE);
+    device.readData();
+    TEST_ASSERT_EQUAL_UINT32(2, PapilioTemplate::getTraceCount());
+
+    PapilioTemplate::TraceSnapshot snapshot = PapilioTemplate::snapshotTrace();
+    TEST_ASSERT_TRUE(PapilioTemplate::getTraceEntry(snapshot, 0, entry));
+    TEST_ASSERT_EQUAL_UINT8(PapilioTemplate::TRACE_WRITE, entry.direction);
+    TEST_ASSERT_EQUAL_UINT8(32, entry.width);
+    TEST_ASSERT_EQUAL_UINT16(device.getBaseAddress(), entry.baseAddress);
+    TEST_ASSERT_EQUAL_UINT32(0xCAFE, entry.value);
+    uint64_t firstTimestamp = entry.timestamp;
+
+    TEST_ASSERT_TRUE(PapilioTemplate::getTraceEntry(snapshot, 1, entry));
+    TEST_ASSERT_EQUAL_UINT8(PapilioTemplate::TRACE_READ, entry.direction);
+    TEST_ASSERT_EQUAL_UINT32(0xCAFE, entry.value);
+    TEST_ASSERT_TRUE(entry.timestamp >= firstTimestamp);
+
+    TEST_ASSERT_FALSE(PapilioTemplate::getTraceEntry(snapshot, 2, entry));
+
+    // Buffer keeps only the newest TRACE_DEPTH entries
+    for (uint32_t i = 0; i < PapilioTemplate::TRACE_DEPTH + 4; i++) {
+        device.writeData(i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(PapilioTemplate::TRACE_DEPTH, PapilioTemplate::getTraceCount());
+    TEST_ASSERT_TRUE(PapilioTemplate::getTraceEntry(PapilioTemplate::TRACE_DEPTH - 1, entry));
+    TEST_ASSERT_EQUAL_UINT32(PapilioTemplate::TRACE_DEPTH + 3, entry.value);
+
+    // Entries overwritten after a snapshot are rejected, not re-read
+    snapshot = PapilioTemplate::snapshotTrace();
+    device.writeData(0);
+    TEST_ASSERT_FALSE(PapilioTemplate::getTraceEntry(snapshot, 0, entry));
+    TEST_ASSERT_TRUE(PapilioTemplate::getTraceEntry(snapshot, 1, entry));
+}
+#endif
+
 // TODO: Add more hardware-specific tests
-// - Test 8: Interrupt functionality (if applicable)
-// - Test 9: DMA operations (if applicable)
-// - Test 10: Error conditions
-// - Test 11: Performance testing
-// - Test 12: Stress testing
+// - Test 9: Interrupt functionality (if applicable)
+// - Test 10: DMA operations (if applicable)
+// - Test 11: Error conditions
+// - Test 12: Performance testing
+// - Test 13: Stress testing
 
 void setup() {
     // Wait for serial connection (2 seconds)
@@ -146,6 +189,9 @@ void setup() {
     RUN_TEST(test_sequential_operations);
     RUN_TEST(test_status_register);
     RUN_TEST(test_base_address);
+#ifdef PAPILIO_TEMPLATE_TRACE
+    RUN_TEST(test_trace);
+#endif
     
     // End Unity testing
     UNITY_END();
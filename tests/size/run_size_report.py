@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Flash/RAM footprint report for papilio_template
+
+Builds the environments in platformio.ini and reports how much flash and RAM
+PapilioTemplate and PapilioTemplateOS add to a firmware image. Results are
+compared against size_baseline.json so size regressions are caught. A
+missing baseline is treated as a failure.
+
+Usage:
+    python run_size_report.py                   # Build, report and check
+    python run_size_report.py --update          # Record new baseline
+    python run_size_report.py --tolerance 512   # Allowed growth in bytes
+"""
+
+import re
+import sys
+import json
+import subprocess
+import argparse
+from pathlib import Path
+
+
+SIZE_DIR = Path(__file__).parent
+BASELINE_FILE = SIZE_DIR / "size_baseline.json"
+
+ENVIRONMENTS = [
+    "baseline",
+    "os_only",
+    "template",
+    "template_trace",
+    "template_os",
+    "template_os_no_tutorial",
+]
+
+# Matches PlatformIO's summary, e.g.
+# "RAM:   [=         ]   6.5% (used 21376 bytes from 327680 bytes)"
+SIZE_PATTERN = re.compile(r"^(RAM|Flash):.*\(used (\d+) bytes", re.MULTILINE)
+
+
+def build_env(env):
+    """Build one environment and return its {'flash': n, 'ram': n} usage"""
+    print(f"Building {env}...")
+    result = subprocess.run(["pio", "run", "-e", env], cwd=str(SIZE_DIR),
+                            capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stdout)
+        print(result.stderr)
+        return None
+
+    usage = {}
+    for region, used in SIZE_PATTERN.findall(result.stdout):
+        usage[region.lower()] = int(used)
+
+    if "flash" not in usage or "ram" not in usage:
+        print(f"Could not find size summary in output for {env}")
+        return None
+
+    return usage
+
+
+def diff(a, b):
+    """Return usage a - b"""
+    return {key: a[key] - b[key] for key in ("flash", "ram")}
+
+
+def compute_footprint(sizes):
+    """Derive per-component footprints from the raw build sizes"""
+    template = diff(sizes["template"], sizes["baseline"])
+    os_plugin = diff(diff(sizes["template_os"], sizes["os_only"]), template)
+    tutorial = diff(sizes["template_os"], sizes["template_os_no_tutorial"])
+    trace = diff(sizes["template_trace"], sizes["template"])
+
+    return {
+        "PapilioTemplate": template,
+        "PapilioTemplateOS": os_plugin,
+        "PapilioTemplateOS (tutorial)": tutorial,
+        "PapilioTemplate (trace)": trace,
+    }
+
+
+def print_report(footprint, baseline):
+    """Print footprint table with deltas against the baseline"""
+    print("\n" + "="*60)
+    print("Footprint Report")
+    print("="*60)
+    print(f"{'Component':<30} {'Flash':>12} {'RAM':>12}")
+
+    for name, usage in footprint.items():
+        line = f"{name:<30} {usage['flash']:>12} {usage['ram']:>12}"
+        if baseline and name in baseline:
+            d = diff(usage, baseline[name])
+            line += f"   ({d['flash']:+} / {d['ram']:+})"
+        print(line)
+
+
+def check_regressions(footprint, baseline, tolerance):
+    """Return list of components that grew by more than tolerance bytes"""
+    failures = []
+    for name, usage in footprint.items():
+        if name not in baseline:
+            continue
+        for key in ("flash", "ram"):
+            growth = usage[key] - baseline[name][key]
+            if growth > tolerance:
+                failures.append(f"{name} {key} grew by {growth} bytes")
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flash/RAM footprint report for papilio_template")
+    parser.add_argument("--update", action="store_true",
+                       help="Write current footprint to size_baseline.json")
+    parser.add_argument("--tolerance", type=int, default=256,
+                       help="Allowed growth in bytes before failing (default 256)")
+    args = parser.parse_args()
+
+    print("="*60)
+    print("Papilio Template - Size Report")
+    print("="*60)
+
+    sizes = {}
+    for env in ENVIRONMENTS:
+        usage = build_env(env)
+        if usage is None:
+            print(f"[FAIL]: Build failed for {env}")
+            return 1
+        sizes[env] = usage
+
+    footprint = compute_footprint(sizes)
+
+    baseline = None
+    if BASELINE_FILE.exists():
+        baseline = json.loads(BASELINE_FILE.read_text())
+
+    print_report(footprint, baseline)
+
+    if args.update:
+        BASELINE_FILE.write_text(json.dumps(footprint, indent=2) + "\n")
+        print(f"\nBaseline written to {BASELINE_FILE.name}")
+        return 0
+
+    if baseline is None:
+        print(f"\n[FAIL]: No {BASELINE_FILE.name} found - run with --update to record one")
+        return 1
+
+    failures = check_regressions(footprint, baseline, args.tolerance)
+    for failure in failures:
+        print(f"[FAIL]: {failure}")
+
+    print(f"\nOverall: {'FAIL' if failures else 'PASS'}")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,51 @@
+/*
+ * Footprint sketch for papilio_lib_template
+ *
+ * Built once per environment in platformio.ini. Every API call is reachable
+ * so the linker cannot discard the code being measured.
+ */
+
+#include <Arduino.h>
+
+#ifdef ENABLE_PAPILIO_OS
+#include <PapilioOS.h>
+#endif
+
+#ifdef SIZE_WITH_TEMPLATE
+#include <PapilioTemplate.h>
+
+PapilioTemplate myDevice(0x1000);
+
+#ifdef ENABLE_PAPILIO_OS
+#include <PapilioTemplateOS.h>
+
+PapilioTemplateOS myDeviceOS(&myDevice);
+#endif
+#endif
+
+// Keeps results observable so calls are not optimized away
+volatile uint32_t sink;
+
+void setup() {
+    Serial.begin(115200);
+
+#ifdef ENABLE_PAPILIO_OS
+    PapilioOS.begin();
+#endif
+
+#ifdef SIZE_WITH_TEMPLATE
+    myDevice.begin();
+    myDevice.setEnable(true);
+    myDevice.writeData(sink);
+    sink = myDevice.readData();
+    sink = myDevice.getStatus();
+    sink = myDevice.isReady();
+    myDevice.reset();
+#endif
+}
+
+void loop() {
+#ifdef ENABLE_PAPILIO_OS
+    PapilioOS.update();
+#endif
+}